@@ -82,6 +82,7 @@ enum {
 #include <pthread.h>
 #include <sched.h>	/* for sched_yield */
 #include <sys/time.h>
+#include <unistd.h>	/* for _POSIX_THREAD_CPUTIME */
 
 #ifndef thread_local
 #define thread_local		_Thread_local
@@ -90,6 +91,18 @@ enum {
 #define ONCE_FLAG_INIT		PTHREAD_ONCE_INIT
 #define TSS_DTOR_ITERATIONS	PTHREAD_DESTRUCTOR_ITERATIONS
 
+/* Non-standard: static initializers, usable instead of mtx_init/cnd_init for
+ * objects with static storage duration. There's no portable pthreads
+ * initializer for recursive mutexes, so check if MTX_RECURSIVE_INIT is defined.
+ */
+#define MTX_PLAIN_INIT		PTHREAD_MUTEX_INITIALIZER
+#ifdef PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP
+#define MTX_RECURSIVE_INIT	PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP
+#elif defined(PTHREAD_RECURSIVE_MUTEX_INITIALIZER)
+#define MTX_RECURSIVE_INIT	PTHREAD_RECURSIVE_MUTEX_INITIALIZER
+#endif
+#define CND_INIT			PTHREAD_COND_INITIALIZER
+
 #ifdef __APPLE__
 /* Darwin doesn't implement timed mutexes currently */
 #define C11THREADS_NO_TIMED_MUTEX
@@ -105,6 +118,25 @@ enum {
 #define C11THREADS_TIMEDLOCK_POLL_INTERVAL 5000000	/* 5 ms */
 #endif
 
+/* thrd_cputime needs per-thread CPU-time clocks (Darwin and pthreads-win32
+ * don't have them)
+ */
+#if !defined(_POSIX_THREAD_CPUTIME) || _POSIX_THREAD_CPUTIME < 0
+#define C11THREADS_NO_THREAD_CPUTIME
+#endif
+
+/* thrd_timedjoin and thrd_tryjoin are only available where pthreads has a
+ * non-portable timed join: GNU libc and musl (with _GNU_SOURCE), and FreeBSD.
+ * glibc only declares it if _GNU_SOURCE was defined before the first system
+ * header (__USE_GNU), musl checks _GNU_SOURCE on each include.
+ */
+#ifdef __FreeBSD__
+#include <pthread_np.h>
+#elif !(defined(__GLIBC__) && defined(__USE_GNU)) && \
+	!(!defined(__GLIBC__) && defined(__linux__) && defined(_GNU_SOURCE) && !defined(__ANDROID__))
+#define C11THREADS_NO_TIMED_JOIN
+#endif
+
 /* types */
 typedef pthread_t thrd_t;
 typedef pthread_mutex_t mtx_t;
@@ -141,6 +173,91 @@ static C11THREADS_INLINE int thrd_join(thrd_t thr, int *res)
 	return thrd_success;
 }
 
+static C11THREADS_INLINE int thrd_create_n(thrd_t *thrs, size_t n, thrd_start_t func, void **args, size_t *started)
+{
+	int res = thrd_success;
+	size_t i;
+
+	for(i=0; i<n; i++) {
+		if((res = thrd_create(thrs + i, func, args ? args[i] : 0)) != thrd_success) {
+			break;
+		}
+	}
+	if(started) {
+		*started = i;
+	}
+	return res;
+}
+
+/* pthreads can't wait for several threads at once, so this wakes up once per thread */
+static C11THREADS_INLINE int thrd_join_all(thrd_t *thrs, size_t n, int *res)
+{
+	int ret = thrd_success;
+	size_t i;
+
+	for(i=0; i<n; i++) {
+		if(thrd_join(thrs[i], res ? res + i : 0) != thrd_success) {
+			ret = thrd_error;
+		}
+	}
+	return ret;
+}
+
+#ifndef C11THREADS_NO_TIMED_JOIN
+static C11THREADS_INLINE int thrd_timedjoin(thrd_t thr, int *res, const struct timespec *ts)
+{
+	int err;
+	void *retval;
+
+	if((err = pthread_timedjoin_np(thr, &retval, ts)) != 0) {
+		return err == ETIMEDOUT ? thrd_timedout : thrd_error;
+	}
+	if(res) {
+		*res = (int)(intptr_t)retval;
+	}
+	return thrd_success;
+}
+
+static C11THREADS_INLINE int thrd_tryjoin(thrd_t thr, int *res)
+{
+	int err;
+	void *retval;
+#ifdef __FreeBSD__
+	/* no pthread_tryjoin_np before FreeBSD 13, an expired deadline does the same */
+	struct timespec ts = {0, 0};
+
+	if((err = pthread_timedjoin_np(thr, &retval, &ts)) == ETIMEDOUT) {
+		err = EBUSY;
+	}
+#else
+	err = pthread_tryjoin_np(thr, &retval);
+#endif
+	if(err != 0) {
+		return err == EBUSY ? thrd_busy : thrd_error;
+	}
+	if(res) {
+		*res = (int)(intptr_t)retval;
+	}
+	return thrd_success;
+}
+#endif
+
+#ifndef C11THREADS_NO_THREAD_CPUTIME
+/* only meaningful while the thread is running: after it exits the result is
+ * unspecified, even if it hasn't been joined yet (glibc fails, musl silently
+ * reports the calling thread's CPU time instead)
+ */
+static C11THREADS_INLINE int thrd_cputime(thrd_t thr, struct timespec *ts)
+{
+	clockid_t clk;
+
+	if(pthread_getcpuclockid(thr, &clk) != 0 || clock_gettime(clk, ts) != 0) {
+		return thrd_error;
+	}
+	return thrd_success;
+}
+#endif
+
 static C11THREADS_INLINE int thrd_detach(thrd_t thr)
 {
 	return pthread_detach(thr) == 0 ? thrd_success : thrd_error;
@@ -414,7 +531,20 @@ int thrd_create(thrd_t *thr, thrd_start_t func, void *arg);
 /* Win32: Threads not created with thrd_create() need to call this to clean up TSS. */
 C11THREADS_MSVC_NORETURN void thrd_exit(int res) C11THREADS_GNUC_NORETURN;
 int thrd_join(thrd_t thr, int *res);
+/* Non-standard: join with an absolute TIME_UTC deadline, or without blocking. */
+static C11THREADS_INLINE int thrd_timedjoin(thrd_t thr, int *res, const struct timespec *ts);
+int thrd_tryjoin(thrd_t thr, int *res);
+/* Non-standard: start or join a whole array of threads at once. On failure,
+ * thrd_create_n stores the number of threads it did start in *started (if not
+ * NULL); the caller is responsible for stopping and joining those.
+ */
+int thrd_create_n(thrd_t *thrs, size_t n, thrd_start_t func, void **args, size_t *started);
+int thrd_join_all(thrd_t *thrs, size_t n, int *res);
 int thrd_detach(thrd_t thr);
+/* Non-standard: CPU time (user + kernel) consumed so far by a thread. Also
+ * works for exited threads until they are joined or detached.
+ */
+static C11THREADS_INLINE int thrd_cputime(thrd_t thr, struct timespec *ts);
 thrd_t thrd_current(void);
 int thrd_equal(thrd_t a, thrd_t b);
 static C11THREADS_INLINE int thrd_sleep(const struct timespec *ts_in, struct timespec *rem_out);
@@ -468,6 +598,28 @@ int c11threads_win32_thrd_register(unsigned long win32_thread_id);
 
 /* ---- thread management ---- */
 
+int _c11threads_win32_thrd_timedjoin32(thrd_t thr, int *res, const struct _c11threads_win32_timespec32_t *ts);
+int _c11threads_win32_thrd_timedjoin64(thrd_t thr, int *res, const struct _c11threads_win32_timespec64_t *ts);
+static C11THREADS_INLINE int thrd_timedjoin(thrd_t thr, int *res, const struct timespec *ts)
+{
+	if (sizeof(ts->tv_sec) == 4) {
+		return _c11threads_win32_thrd_timedjoin32(thr, res, (const struct _c11threads_win32_timespec32_t*)ts);
+	} else {
+		return _c11threads_win32_thrd_timedjoin64(thr, res, (const struct _c11threads_win32_timespec64_t*)ts);
+	}
+}
+
+int _c11threads_win32_thrd_cputime32(thrd_t thr, struct _c11threads_win32_timespec32_t *ts);
+int _c11threads_win32_thrd_cputime64(thrd_t thr, struct _c11threads_win32_timespec64_t *ts);
+static C11THREADS_INLINE int thrd_cputime(thrd_t thr, struct timespec *ts)
+{
+	if (sizeof(ts->tv_sec) == 4) {
+		return _c11threads_win32_thrd_cputime32(thr, (struct _c11threads_win32_timespec32_t*)ts);
+	} else {
+		return _c11threads_win32_thrd_cputime64(thr, (struct _c11threads_win32_timespec64_t*)ts);
+	}
+}
+
 int _c11threads_win32_thrd_sleep32(const struct _c11threads_win32_timespec32_t *ts_in, struct _c11threads_win32_timespec32_t *rem_out);
 int _c11threads_win32_thrd_sleep64(const struct _c11threads_win32_timespec64_t *ts_in, struct _c11threads_win32_timespec64_t *rem_out);
 static C11THREADS_INLINE int thrd_sleep(const struct timespec *ts_in, struct timespec *rem_out)
@@ -526,6 +678,56 @@ static C11THREADS_INLINE int timespec_get(struct timespec *ts, int base)
 
 #endif	/* C11THREADS_WIN32 */
 
+/* Non-standard: mutexes and condition variables padded and aligned to a
+ * cache line, so that arrays of them, or locks placed next to other hot data,
+ * don't share cache lines. Use the existing functions on the inner member,
+ * e.g. mtx_lock(&locks[i].mtx).
+ * The alignment only applies to static, automatic and member storage: malloc
+ * doesn't honour it, so allocate arrays of these on the heap with
+ * aligned_alloc/posix_memalign (or _aligned_malloc on win32), passing
+ * C11THREADS_CACHELINE as the alignment.
+ *
+ * C11THREADS_CACHELINE can be defined before including this header to match
+ * the target, e.g. -DC11THREADS_CACHELINE=$(getconf LEVEL1_DCACHE_LINESIZE)
+ * but beware that getconf reports 0 on some systems where the size is unknown.
+ */
+#ifndef C11THREADS_CACHELINE
+#if (defined(__APPLE__) && defined(__aarch64__)) || defined(__powerpc64__)
+#define C11THREADS_CACHELINE	128
+#else
+#define C11THREADS_CACHELINE	64
+#endif
+#endif
+
+#if C11THREADS_CACHELINE < 1
+#error "C11THREADS_CACHELINE must be positive (getconf reports 0 when the size is unknown)"
+#endif
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define C11THREADS_CACHELINE_ALIGN	alignas(C11THREADS_CACHELINE)
+#elif __STDC_VERSION__ >= 201112L
+#define C11THREADS_CACHELINE_ALIGN	_Alignas(C11THREADS_CACHELINE)
+#elif defined(_MSC_VER)
+#define C11THREADS_CACHELINE_ALIGN	__declspec(align(C11THREADS_CACHELINE))
+#elif defined(__GNUC__)
+#define C11THREADS_CACHELINE_ALIGN	__attribute__((aligned(C11THREADS_CACHELINE)))
+#else
+#define C11THREADS_CACHELINE_ALIGN
+#endif
+
+#define C11THREADS_CACHELINE_PAD(type) \
+	((sizeof(type) + C11THREADS_CACHELINE - 1) / C11THREADS_CACHELINE * C11THREADS_CACHELINE)
+
+typedef union {
+	C11THREADS_CACHELINE_ALIGN mtx_t mtx;
+	char pad[C11THREADS_CACHELINE_PAD(mtx_t)];
+} mtx_padded_t;
+
+typedef union {
+	C11THREADS_CACHELINE_ALIGN cnd_t cnd;
+	char pad[C11THREADS_CACHELINE_PAD(cnd_t)];
+} cnd_padded_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -434,6 +434,30 @@ static void *_c11threads_win32_thrd_pop_entry(thrd_t thrd)
 	return h;
 }
 
+static void *_c11threads_win32_thrd_get_entry(thrd_t thrd)
+{
+	void *h;
+	struct _c11threads_win32_thrd_entry_t *curr;
+
+	h = NULL;
+
+	_c11threads_win32_ensure_initialized();
+	EnterCriticalSection(&_c11threads_win32_thrd_list_critical_section);
+	curr = _c11threads_win32_thrd_list_head;
+	while (curr)
+	{
+		if (curr->thrd == thrd) {
+			h = curr->h;
+			break;
+		}
+
+		curr = curr->next;
+	}
+	LeaveCriticalSection(&_c11threads_win32_thrd_list_critical_section);
+
+	return h;
+}
+
 static void _c11threads_win32_thrd_run_tss_dtors(void)
 {
 	int ran_dtor;
@@ -586,15 +610,27 @@ void thrd_exit(int res)
 	ExitThread(res);
 }
 
-int thrd_join(thrd_t thr, int *res)
+static int _c11threads_win32_thrd_join_common(thrd_t thr, int *res, unsigned long wait_time)
 {
 	int ret;
 	void *h;
+	unsigned long wait_status;
+
+	h = _c11threads_win32_thrd_get_entry(thr);
+	if (!h) {
+		return thrd_error;
+	}
+
+	/* Keep the entry registered until the thread has actually terminated, so a timed out join can be retried. */
+	wait_status = WaitForSingleObject(h, wait_time);
+	if (wait_status == WAIT_TIMEOUT) {
+		return thrd_timedout;
+	}
 
 	ret = thrd_error;
 	h = _c11threads_win32_thrd_pop_entry(thr);
 	if (h) {
-		if (WaitForSingleObject(h, INFINITE) == WAIT_OBJECT_0 && (!res || GetExitCodeThread(h, (unsigned long*)res))) {
+		if (wait_status == WAIT_OBJECT_0 && (!res || GetExitCodeThread(h, (unsigned long*)res))) {
 			ret = thrd_success;
 		}
 
@@ -604,6 +640,121 @@ int thrd_join(thrd_t thr, int *res)
 	return ret;
 }
 
+int thrd_join(thrd_t thr, int *res)
+{
+	return _c11threads_win32_thrd_join_common(thr, res, INFINITE);
+}
+
+int _c11threads_win32_thrd_timedjoin32(thrd_t thr, int *res, const struct _c11threads_win32_timespec32_t *ts)
+{
+	struct _c11threads_win32_timespec32_t current_time;
+	unsigned long wait_time;
+	int clamped;
+	int ret;
+
+	if (!_c11threads_win32_util_is_timespec32_valid(ts)) {
+		return thrd_error;
+	}
+
+	do {
+		if (!_c11threads_win32_timespec32_get(&current_time, TIME_UTC)) {
+			return thrd_error;
+		}
+
+		wait_time = _c11threads_win32_util_timepoint_to_millisecond_timespan32(&current_time, ts, &clamped);
+		ret = _c11threads_win32_thrd_join_common(thr, res, wait_time);
+	} while (ret == thrd_timedout && clamped);
+
+	return ret;
+}
+
+int _c11threads_win32_thrd_timedjoin64(thrd_t thr, int *res, const struct _c11threads_win32_timespec64_t *ts)
+{
+	struct _c11threads_win32_timespec64_t current_time;
+	unsigned long wait_time;
+	int clamped;
+	int ret;
+
+	if (!_c11threads_win32_util_is_timespec64_valid(ts)) {
+		return thrd_error;
+	}
+
+	do {
+		if (!_c11threads_win32_timespec64_get(&current_time, TIME_UTC)) {
+			return thrd_error;
+		}
+
+		wait_time = _c11threads_win32_util_timepoint_to_millisecond_timespan64(&current_time, ts, &clamped);
+		ret = _c11threads_win32_thrd_join_common(thr, res, wait_time);
+	} while (ret == thrd_timedout && clamped);
+
+	return ret;
+}
+
+int thrd_tryjoin(thrd_t thr, int *res)
+{
+	int ret;
+	ret = _c11threads_win32_thrd_join_common(thr, res, 0);
+	return ret == thrd_timedout ? thrd_busy : ret;
+}
+
+int thrd_create_n(thrd_t *thrs, size_t n, thrd_start_t func, void **args, size_t *started)
+{
+	int res;
+	size_t i;
+
+	res = thrd_success;
+	for (i = 0; i < n; ++i) {
+		res = thrd_create(thrs + i, func, args ? args[i] : NULL);
+		if (res != thrd_success) {
+			break;
+		}
+	}
+
+	if (started) {
+		*started = i;
+	}
+	return res;
+}
+
+int thrd_join_all(thrd_t *thrs, size_t n, int *res)
+{
+	int ret;
+	size_t i;
+	size_t j;
+	size_t batch_size;
+	unsigned long handle_count;
+	void *handles[MAXIMUM_WAIT_OBJECTS];
+
+	ret = thrd_success;
+	for (i = 0; i < n; i += batch_size) {
+		batch_size = n - i < MAXIMUM_WAIT_OBJECTS ? n - i : MAXIMUM_WAIT_OBJECTS;
+
+		/* Wait for the whole batch with a single wakeup, then collect the exit codes. */
+		handle_count = 0;
+		for (j = 0; j < batch_size; ++j) {
+			handles[handle_count] = _c11threads_win32_thrd_get_entry(thrs[i + j]);
+			if (handles[handle_count]) {
+				++handle_count;
+			}
+		}
+		/* The result is deliberately ignored: if the wait fails (e.g. WAIT_FAILED because a thread
+		 * appears twice), the per-thread thrd_join below falls back to waiting for each thread in turn.
+		 */
+		if (handle_count) {
+			WaitForMultipleObjects(handle_count, handles, 1, INFINITE);
+		}
+
+		for (j = 0; j < batch_size; ++j) {
+			if (thrd_join(thrs[i + j], res ? res + i + j : NULL) != thrd_success) {
+				ret = thrd_error;
+			}
+		}
+	}
+
+	return ret;
+}
+
 int thrd_detach(thrd_t thr)
 {
 	void *h;
@@ -616,6 +767,67 @@ thrd_t thrd_current(void)
 	return GetCurrentThreadId();
 }
 
+/* Returns user + kernel time in 100 ns units, or -1 on failure. */
+static __int64 _c11threads_win32_thrd_cputime_common(thrd_t thr)
+{
+	void *h;
+	FILETIME creation_time;
+	FILETIME exit_time;
+	FILETIME kernel_time;
+	FILETIME user_time;
+	ULARGE_INTEGER kernel_li;
+	ULARGE_INTEGER user_li;
+
+	/* The calling thread doesn't need to be registered. */
+	if (thr == GetCurrentThreadId()) {
+		h = GetCurrentThread();
+	} else {
+		h = _c11threads_win32_thrd_get_entry(thr);
+		if (!h) {
+			return -1;
+		}
+	}
+
+	if (!GetThreadTimes(h, &creation_time, &exit_time, &kernel_time, &user_time)) {
+		return -1;
+	}
+
+	kernel_li.LowPart = kernel_time.dwLowDateTime;
+	kernel_li.HighPart = kernel_time.dwHighDateTime;
+	user_li.LowPart = user_time.dwLowDateTime;
+	user_li.HighPart = user_time.dwHighDateTime;
+
+	return (__int64)(kernel_li.QuadPart + user_li.QuadPart);
+}
+
+int _c11threads_win32_thrd_cputime32(thrd_t thr, struct _c11threads_win32_timespec32_t *ts)
+{
+	__int64 cpu_time;
+
+	cpu_time = _c11threads_win32_thrd_cputime_common(thr);
+	if (cpu_time < 0) {
+		return thrd_error;
+	}
+
+	ts->tv_sec = (long)(cpu_time / 10000000);
+	ts->tv_nsec = (long)(cpu_time % 10000000) * 100;
+	return thrd_success;
+}
+
+int _c11threads_win32_thrd_cputime64(thrd_t thr, struct _c11threads_win32_timespec64_t *ts)
+{
+	__int64 cpu_time;
+
+	cpu_time = _c11threads_win32_thrd_cputime_common(thr);
+	if (cpu_time < 0) {
+		return thrd_error;
+	}
+
+	ts->tv_sec = cpu_time / 10000000;
+	ts->tv_nsec = (long)(cpu_time % 10000000) * 100;
+	return thrd_success;
+}
+
 static int _c11threads_win32_sleep_common(__int64 file_time_in)
 {
 	void *timer;
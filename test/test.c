@@ -1,5 +1,8 @@
 /* Test program for c11threads. */
 
+/* Needed for thrd_timedjoin() and thrd_tryjoin() on GNU/Linux. */
+#define _GNU_SOURCE
+
 /* Needed for memory leak detection. */
 #ifdef _WIN32
 #define _CRTDBG_MAP_ALLOC
@@ -24,13 +27,25 @@ cnd_t cnd;
 cnd_t cnd2;
 tss_t tss;
 once_flag once = ONCE_FLAG_INIT;
+#ifdef MTX_PLAIN_INIT
+mtx_t static_mtx = MTX_PLAIN_INIT;
+cnd_t static_cnd = CND_INIT;
+#endif
+#ifdef MTX_RECURSIVE_INIT
+mtx_t static_recursive_mtx = MTX_RECURSIVE_INIT;
+#endif
 int flag;
 
 void run_thread_test(void);
+void run_thread_n_test(void);
+void run_timed_join_test(void);
 void run_timed_mtx_test(void);
 void run_cnd_test(void);
 void run_tss_test(void);
 void run_call_once_test(void);
+void run_padded_test(void);
+void run_static_init_test(void);
+void run_cputime_test(void);
 
 int main(void)
 {
@@ -38,6 +53,16 @@ int main(void)
 	run_thread_test();
 	puts("end thread test\n");
 
+	puts("start bulk thread test");
+	run_thread_n_test();
+	puts("end bulk thread test\n");
+
+#ifndef C11THREADS_NO_TIMED_JOIN
+	puts("start timed join test");
+	run_timed_join_test();
+	puts("end timed join test\n");
+#endif
+
 	puts("start timed mutex test");
 	run_timed_mtx_test();
 	puts("end timed mutex test\n");
@@ -54,6 +79,22 @@ int main(void)
 	run_call_once_test();
 	puts("end call once test\n");
 
+	puts("start padded types test");
+	run_padded_test();
+	puts("end padded types test\n");
+
+#ifdef MTX_PLAIN_INIT
+	puts("start static initializer test");
+	run_static_init_test();
+	puts("end static initializer test\n");
+#endif
+
+#ifndef C11THREADS_NO_THREAD_CPUTIME
+	puts("start thread CPU time test");
+	run_cputime_test();
+	puts("end thread CPU time test\n");
+#endif
+
 #if defined(_WIN32) && !defined(C11THREADS_PTHREAD_WIN32)
 	c11threads_win32_destroy();
 #endif
@@ -130,6 +171,76 @@ void run_thread_test(void)
 	}
 }
 
+int return_arg_func(void *arg)
+{
+	return (int)(size_t)arg;
+}
+
+void run_thread_n_test(void)
+{
+	int i;
+	thrd_t threads[NUM_THREADS];
+	void *args[NUM_THREADS];
+	int results[NUM_THREADS];
+	size_t started;
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		args[i] = (void*)(size_t)(i + 1);
+		results[i] = 0;
+	}
+
+	started = 0;
+	CHK_THRD(thrd_create_n(threads, NUM_THREADS, return_arg_func, args, &started));
+	CHK_EXPECTED((int)started, NUM_THREADS);
+	CHK_THRD(thrd_join_all(threads, NUM_THREADS, results));
+	for (i = 0; i < NUM_THREADS; i++) {
+		CHK_EXPECTED(results[i], i + 1);
+	}
+	puts("all threads returned their argument");
+}
+
+#ifndef C11THREADS_NO_TIMED_JOIN
+int sleep_one_second_and_return_42(void *arg)
+{
+	struct timespec dur;
+
+	(void)arg;
+
+	dur.tv_sec = 1;
+	dur.tv_nsec = 0;
+	CHK_EXPECTED(thrd_sleep(&dur, NULL), 0);
+
+	return 42;
+}
+
+void run_timed_join_test(void)
+{
+	thrd_t thread;
+	struct timespec ts;
+	int res;
+
+	CHK_THRD(thrd_create(&thread, sleep_one_second_and_return_42, NULL));
+
+	CHK_THRD_EXPECTED(thrd_tryjoin(thread, &res), thrd_busy);
+	puts("thread is still running & tryjoin returned busy");
+
+	CHK_EXPECTED(timespec_get(&ts, TIME_UTC), TIME_UTC);
+	ts.tv_nsec += 500000000;
+	if (ts.tv_nsec >= 1000000000) {
+		++ts.tv_sec;
+		ts.tv_nsec -= 1000000000;
+	}
+	CHK_THRD_EXPECTED(thrd_timedjoin(thread, &res, &ts), thrd_timedout);
+	puts("thread is still running & we timed out joining it");
+
+	CHK_EXPECTED(timespec_get(&ts, TIME_UTC), TIME_UTC);
+	ts.tv_sec += 2;
+	CHK_THRD(thrd_timedjoin(thread, &res, &ts));
+	puts("thread finished & we joined it");
+	CHK_EXPECTED(res, 42);
+}
+#endif
+
 #if !defined(_WIN32) || defined(C11THREADS_PTHREAD_WIN32) || !defined(C11THREADS_OLD_WIN32API)
 int hold_mutex_for_one_second(void* arg)
 {
@@ -345,3 +456,203 @@ void run_call_once_test(void)
 
 	CHK_EXPECTED(flag, 1);
 }
+
+#define LOCK_ITERATIONS 200000
+
+int lock_unlock_loop_func(void *arg)
+{
+	int i;
+	mtx_t *m;
+
+	m = arg;
+	for (i = 0; i < LOCK_ITERATIONS; i++) {
+		CHK_THRD(mtx_lock(m));
+		CHK_THRD(mtx_unlock(m));
+	}
+	return i;
+}
+
+/* Each thread locks its own mutex: packed mutexes still contend through shared
+ * cache lines, padded ones shouldn't. Timings are informative only.
+ */
+long run_lock_loop_threads(mtx_t **mtxs)
+{
+	int i;
+	int res;
+	thrd_t threads[NUM_THREADS];
+	struct timespec start;
+	struct timespec end;
+
+	CHK_EXPECTED(timespec_get(&start, TIME_UTC), TIME_UTC);
+	for (i = 0; i < NUM_THREADS; i++) {
+		CHK_THRD(thrd_create(threads + i, lock_unlock_loop_func, mtxs[i]));
+	}
+	for (i = 0; i < NUM_THREADS; i++) {
+		CHK_THRD(thrd_join(threads[i], &res));
+		CHK_EXPECTED(res, LOCK_ITERATIONS);
+	}
+	CHK_EXPECTED(timespec_get(&end, TIME_UTC), TIME_UTC);
+
+	return (long)(end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+}
+
+void run_padded_contention_test(void)
+{
+	int i;
+	mtx_t packed[NUM_THREADS];
+	mtx_padded_t padded[NUM_THREADS];
+	mtx_t *mtxs[NUM_THREADS];
+	long packed_ms;
+	long padded_ms;
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		CHK_THRD(mtx_init(&packed[i], mtx_plain));
+		CHK_THRD(mtx_init(&padded[i].mtx, mtx_plain));
+	}
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		mtxs[i] = &packed[i];
+	}
+	packed_ms = run_lock_loop_threads(mtxs);
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		mtxs[i] = &padded[i].mtx;
+	}
+	padded_ms = run_lock_loop_threads(mtxs);
+
+	printf("%d threads x %d lock/unlock: packed mtx_t %ld ms, mtx_padded_t %ld ms\n",
+			NUM_THREADS, LOCK_ITERATIONS, packed_ms, padded_ms);
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		mtx_destroy(&packed[i]);
+		mtx_destroy(&padded[i].mtx);
+	}
+}
+
+void run_padded_test(void)
+{
+	int i;
+	mtx_padded_t mtxs[2];
+	cnd_padded_t cnds[2];
+
+	printf("cache line: %d, sizeof(mtx_padded_t): %d, sizeof(cnd_padded_t): %d\n", C11THREADS_CACHELINE,
+			(int)sizeof(mtx_padded_t), (int)sizeof(cnd_padded_t));
+	CHK_EXPECTED((int)(sizeof(mtx_padded_t) % C11THREADS_CACHELINE), 0);
+	CHK_EXPECTED((int)(sizeof(cnd_padded_t) % C11THREADS_CACHELINE), 0);
+	CHK_EXPECTED((int)((size_t)&mtxs[1].mtx % C11THREADS_CACHELINE), 0);
+	CHK_EXPECTED((int)((size_t)&cnds[1].cnd % C11THREADS_CACHELINE), 0);
+
+	for (i = 0; i < 2; i++) {
+		CHK_THRD(mtx_init(&mtxs[i].mtx, mtx_plain));
+		CHK_THRD(cnd_init(&cnds[i].cnd));
+		CHK_THRD(mtx_lock(&mtxs[i].mtx));
+		CHK_THRD(cnd_signal(&cnds[i].cnd));
+		CHK_THRD(mtx_unlock(&mtxs[i].mtx));
+		cnd_destroy(&cnds[i].cnd);
+		mtx_destroy(&mtxs[i].mtx);
+	}
+
+	run_padded_contention_test();
+}
+
+#ifdef MTX_PLAIN_INIT
+int my_static_init_thread_func(void *arg)
+{
+	(void)arg;
+	CHK_THRD(mtx_lock(&static_mtx));
+#ifdef MTX_RECURSIVE_INIT
+	CHK_THRD(mtx_lock(&static_recursive_mtx));
+	CHK_THRD(mtx_lock(&static_recursive_mtx));
+	++flag;
+	CHK_THRD(mtx_unlock(&static_recursive_mtx));
+	CHK_THRD(mtx_unlock(&static_recursive_mtx));
+#else
+	++flag;
+#endif
+	CHK_THRD(cnd_signal(&static_cnd));
+	CHK_THRD(mtx_unlock(&static_mtx));
+	return 0;
+}
+
+void run_static_init_test(void)
+{
+	int i;
+	thrd_t threads[NUM_THREADS];
+
+	flag = 0;
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		CHK_THRD(thrd_create(threads + i, my_static_init_thread_func, NULL));
+	}
+
+	CHK_THRD(mtx_lock(&static_mtx));
+	while (flag != NUM_THREADS) {
+		CHK_THRD(cnd_wait(&static_cnd, &static_mtx));
+	}
+	CHK_THRD(mtx_unlock(&static_mtx));
+	puts("all threads incremented flag under the statically initialized mutex");
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		CHK_THRD(thrd_join(threads[i], NULL));
+	}
+}
+#endif
+
+#ifndef C11THREADS_NO_THREAD_CPUTIME
+long cputime_ms(const struct timespec *ts)
+{
+	return (long)ts->tv_sec * 1000 + ts->tv_nsec / 1000000;
+}
+
+int my_cputime_thread_func(void *arg)
+{
+	struct timespec start;
+	struct timespec now;
+	struct timespec dur;
+
+	(void)arg;
+
+	/* Sleeping doesn't consume CPU time. */
+	CHK_THRD(thrd_cputime(thrd_current(), &start));
+	dur.tv_sec = 0;
+	dur.tv_nsec = 200000000;
+	CHK_EXPECTED(thrd_sleep(&dur, NULL), 0);
+	CHK_THRD(thrd_cputime(thrd_current(), &now));
+	CHK_EXPECTED(cputime_ms(&now) - cputime_ms(&start) < 100, 1);
+
+	/* Spinning does. */
+	do {
+		CHK_THRD(thrd_cputime(thrd_current(), &now));
+	} while (cputime_ms(&now) - cputime_ms(&start) < 50);
+	printf("thread used %ld ms of CPU time\n", cputime_ms(&now));
+	return 0;
+}
+
+void run_cputime_test(void)
+{
+	thrd_t thread;
+	struct timespec ts;
+#if defined(_WIN32) && !defined(C11THREADS_PTHREAD_WIN32)
+	struct timespec dur;
+#endif
+
+	CHK_THRD(thrd_create(&thread, my_cputime_thread_func, NULL));
+	CHK_THRD(thrd_cputime(thread, &ts));
+	CHK_THRD(thrd_join(thread, NULL));
+	CHK_THRD(thrd_cputime(thrd_current(), &ts));
+	printf("main thread used %ld ms of CPU time\n", cputime_ms(&ts));
+
+#if defined(_WIN32) && !defined(C11THREADS_PTHREAD_WIN32)
+	/* Win32: the thread handle keeps the times until the thread is joined.
+	 * With POSIX threads the result for an exited thread is unspecified.
+	 */
+	CHK_THRD(thrd_create(&thread, return_arg_func, NULL));
+	dur.tv_sec = 0;
+	dur.tv_nsec = 500000000;
+	CHK_EXPECTED(thrd_sleep(&dur, NULL), 0);
+	CHK_THRD(thrd_cputime(thread, &ts));
+	puts("got CPU time of exited thread");
+	CHK_THRD(thrd_join(thread, NULL));
+#endif
+}
+#endif